@@ -0,0 +1,177 @@
+#!/bin/sh
+#
+# Writes the synthetic corpus used by "make compare" and as the seed corpus
+# of "make fuzz": every supported magic, truncated and boundary-length
+# headers, wrong extensions and near-miss ftyp/PK/HTML headers.
+#
+# Usage: ./corpus.sh <directory>
+
+if [ $# -ne 1 ]; then
+    echo "Usage: $0 <directory>" >&2
+    exit 1
+fi
+
+DIR=$1
+mkdir -p "$DIR" || exit 1
+
+# put <name> <printf format>: writes one corpus file (octal escapes only, for POSIX printf)
+put() {
+    printf "$2" > "$DIR/$1" || exit 1
+}
+
+# pad <name> <count> [char]: appends <count> spaces (or [char]) to a corpus file
+pad() {
+    head -c "$2" /dev/zero | tr '\000' "${3:- }" >> "$DIR/$1" || exit 1
+}
+
+# padded <name> <count> <printf format>: <count> spaces followed by the format
+padded() {
+    : > "$DIR/$1" || exit 1
+    pad "$1" "$2"
+    printf "$3" >> "$DIR/$1" || exit 1
+}
+
+# Supported magics
+put pdf.pdf '%%PDF-1.4\n%%\342\343\317\323\n1 0 obj\n<<>>\nendobj\n%%%%EOF\n'
+put gif87.gif 'GIF87a\001\000\001\000\200\000\000\000\000\000\377\377\377,\000\000\000\000\001\000\001\000\000\002\002D\001\000;'
+put gif89.gif 'GIF89a\001\000\001\000\200\000\000\000\000\000\377\377\377!\371\004\001\000\000\000\000,\000\000\000\000\001\000\001\000\000\002\002D\001\000;'
+put jfif.jpg '\377\330\377\340\000\020JFIF\000\001\001\000\000\001\000\001\000\000\377\331'
+put exif.jpg '\377\330\377\341\000\010Exif\000\000\377\331'
+put png.png '\211PNG\r\n\032\n\000\000\000\rIHDR\000\000\000\001\000\000\000\001\010\002\000\000\000\220wS\336'
+put iso2.mp4 '\000\000\000\030ftypiso2\000\000\002\000iso2mp41\000\000\000\010free'
+put avc1.mp4 '\000\000\000\030ftypavc1\000\000\000\000avc1isom\000\000\000\010free'
+put dash.mp4 '\000\000\000\030ftypdash\000\000\000\000iso6mp41\000\000\000\010free'
+put isom.mp4 '\000\000\000\030ftypisom\000\000\002\000isomiso2\000\000\000\010free'
+put mp41.mp4 '\000\000\000\024ftypmp41\000\000\000\000mp41\000\000\000\010free'
+put mmp4.mp4 '\000\000\000\030ftypmmp4\000\000\000\000mmp4isom\000\000\000\010free'
+put f4v.mp4 '\000\000\000\030ftypF4V \000\000\000\000F4V isom\000\000\000\010free'
+put m4p.mp4 '\000\000\000\030ftypM4P \000\000\000\000M4P isom\000\000\000\010free'
+put isml.mp4 '\000\000\000\030ftypisml\000\000\000\000isml\000\000\000\000\000\000\000\010free'
+put mp42.mp4 '\000\000\000\030ftypmp42\000\000\000\000mp42isom\000\000\000\010free'
+put local.zip 'PK\003\004\024\000\000\000\000\000\000\000!\000\206\246\020\066\005\000\000\000\005\000\000\000\005\000\000\000a.txthelloPK\001\002\024\003\024\000\000\000\000\000\000\000!\000\206\246\020\066\005\000\000\000\005\000\000\000\005\000\000\000\000\000\000\000\000\000\000\000\244\201\000\000\000\000a.txtPK\005\006\000\000\000\000\001\000\001\000\063\000\000\000(\000\000\000\000\000'
+put comment.zip 'PK\003\004\024\000\000\000\000\000\000\000!\000\206\246\020\066\005\000\000\000\005\000\000\000\005\000\000\000a.txthelloPK\001\002\024\003\024\000\000\000\000\000\000\000!\000\206\246\020\066\005\000\000\000\005\000\000\000\005\000\000\000\000\000\000\000\000\000\000\000\244\201\000\000\000\000a.txtPK\005\006\000\000\000\000\001\000\001\000\063\000\000\000(\000\000\000\016\000archive note.'
+put empty.zip 'PK\005\006\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000'
+put doctype.html '<!DOCTYPE html>\n<html><head><title>t</title></head><body>x</body></html>\n'
+put lower.html '<html>\n<body>x</body>\n</html>\n'
+put head.html '<head><title>t</title></head>\n'
+put title.html '<title>t</title>\n'
+put style.html '<style>p {}</style>\n'
+put table.html '<table border=1></table>\n'
+put ahref.html '<A  HREF="x">x</a>\n'
+put inline.html 'hello <html>\n'
+put doctype-newline.html '<!doctype\n html>\n'
+put latin1.html 'caf\351 <html>\n'
+put esc.html '\033 <html>\n'
+put upper.html '<HTML><BODY>x</BODY></HTML>\n'
+put indented.html '\n  \t<!doctype html>\n<html></html>\n'
+
+# Truncated and boundary-length headers
+put empty.txt ''
+put pdf4.pdf '%%PDF'
+put pdf5.pdf '%%PDF-'
+put gif5.gif 'GIF89'
+put jpg2.jpg '\377\330'
+put png7.png '\211PNG\r\n\032'
+put ftyp8.mp4 '\000\000\000\030ftyp'
+put ftyp11.mp4 '\000\000\000\030ftypiso'
+put ftyp12.mp4 '\000\000\000\030ftypisom'
+put pk3.zip 'PK\003'
+put html4.html '<htm'
+put whitespace.html '   \n\t '
+put gif3.gif 'GIF'
+put gif4.gif 'GIF8'
+put jpg3.jpg '\377\330\377'
+put jpg4.jpg '\377\330\377\333'
+put png8.png '\211PNG\r\n\032\n'
+put png16.png '\211PNG\r\n\032\n\000\000\000\rIHDR'
+put pk4.zip 'PK\003\004'
+put eocd4.zip 'PK\005\006'
+put pdf-pad.pdf '%%PDF-1.4\n'
+pad pdf-pad.pdf 5000
+padded pdf256.pdf 256 '%%PDF-1.4\n'
+padded pdf257.pdf 257 '%%PDF-1.4\n'
+padded html4095.html 4095 '<html>\n'
+padded html4096.html 4096 '<html>\n'
+put html-long.html '<html>\n'
+pad html-long.html 5000
+put html-late-binary.html '<html>\n'
+pad html-late-binary.html 6000
+pad html-late-binary.html 1 '\000'
+put html-binary65535.html '<html>\n'
+pad html-binary65535.html 65528
+pad html-binary65535.html 1 '\001'
+put html-binary65536.html '<html>\n'
+pad html-binary65536.html 65529
+pad html-binary65536.html 1 '\001'
+put pdf-late-binary.pdf 'xx%%PDF-1.4\n'
+pad pdf-late-binary.pdf 5000
+pad pdf-late-binary.pdf 1 '\000'
+put pk49.zip 'PK\003\004\024\000'
+pad pk49.zip 43 '\000'
+put pk50.zip 'PK\003\004\024\000'
+pad pk50.zip 44 '\000'
+put pk-name51.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\024\000\000\000'
+pad pk-name51.zip 21 a
+put pk-name52.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\024\000\000\000'
+pad pk-name52.zip 22 a
+
+# Not regular files: file(1) reports them as inode/*, the detector skips them
+mkfifo "$DIR/fifo.png" 2>/dev/null
+ln -sf pdf.pdf "$DIR/link.png"
+
+# Wrong extensions
+put pdf.png '%%PDF-1.4\n%%%%EOF\n'
+put png.jpg '\211PNG\r\n\032\n\000\000\000\rIHDR\000\000\000\001\000\000\000\001\010\002\000\000\000\220wS\336'
+put zip.html 'PK\005\006\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000'
+put html.pdf '<html><body>x</body></html>\n'
+put gif.mp4 'GIF89a\001\000\001\000\000\000\000;'
+put text.gif 'just some text\n'
+
+# Near misses
+put quicktime.mp4 '\000\000\000\024ftypqt  \000\000\002\000qt  \000\000\000\010free'
+put m4v.mp4 '\000\000\000\030ftypM4V \000\000\000\001M4V isom\000\000\000\010free'
+put 3gp.mp4 '\000\000\000\024ftyp3gp4\000\000\000\000isom\000\000\000\010free'
+put ftyp-offset.mp4 '\000\000\000\000\000ftypisom\000\000\000\000'
+put pk-local.zip 'PK\003\004\024\000\000\000\010\000'
+put epub.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\010\000\000\000mimetypeapplication/epub+zip'
+pad epub.zip 30 x
+put epub-eocd.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\010\000\000\000mimetypeapplication/epub+zipPK\005\006\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000'
+put mimetype.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\010\000\000\000mimetype'
+pad mimetype.zip 40 x
+put docx.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\021\000\000\000word/document.xml'
+pad docx.zip 40 x
+put xlsx.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\017\000\000\000xl/workbook.xml'
+pad xlsx.zip 40 x
+put pptx.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\024\000\000\000ppt/presentation.xml'
+pad pptx.zip 40 x
+put jar.zip 'PK\003\004\024\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\011\000\000\000META-INF/'
+pad jar.zip 40 x
+put xml.html '<?xml version="1.0"?>\n<html>\n</html>\n'
+put xml-upper.html '<?XML version="1.0"?>\n<html>\n'
+put xml-indented.html ' <?xml version="1.0"?>\n<html>\n'
+put svg.html '<svg xmlns="http://www.w3.org/2000/svg"><script>x</script></svg>\n'
+put svg-doctype.html '<!doctype  svg>\n<html>\n'
+put svg-upper.html '<SVG><script>\n'
+put svg-inline.html '<html>\n<svg></svg>\n</html>\n'
+put pk12.zip 'PK\001\002\024\003\024\000\000\000\000\000'
+put pk78.zip 'PK\007\010\000\000\000\000\000\000\000\000'
+put pk-lower.zip 'pk\003\004\024\000\000\000\000\000'
+put htmx.html '<htmx>\n'
+put html-eof.html '<html'
+put htmlx.html '<htmlx>\n'
+put body.html '<body>x</body>\n'
+put doctypehtml.html '<!DOCTYPEhtml>\n'
+put html-binary.html 'ab\001cd <html>\n'
+put html-del.html '\177 <html>\n'
+put pdf-binary.pdf 'xx%%PDF-\001\000'
+put pdf-offset.pdf ' \n%%PDF-1.4\n'
+put pdf-zero.pdf '\000%%PDF-1.4\n'
+put mp71.mp4 '\000\000\000\030ftypmp71\000\000\000\000isom\000\000\000\010free'
+put eocd-end.zip 'abcdefghijPK\005\006\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000'
+put eocd-comment.zip 'PK\003\004junkjunkjunkPK\005\006\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\002\000ab'
+put eocd-gif.zip 'GIF89aPK\005\006\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000'
+put xhtml-text.html 'hello <html>\n'
+put gif88.gif 'GIF88a\001\000\001\000\000\000\000;'
+put jpg-ff.jpg '\377\330\000\340\000\020JFIF\000'
+put png-lf.png '\211PNG\n\n\032\n\000\000\000\rIHDR'
+put pdf-lower.pdf '%%pdf-1.4\n'
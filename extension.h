@@ -1,3 +1,6 @@
+#ifndef EXTENSION_H
+#define EXTENSION_H
+
 /* Public libraries */
 #include <string.h>
 
@@ -13,14 +16,16 @@
 /* Structs */
 typedef struct /* Struct to save the values for the summary output */
 {
-    int files_ok;
-    int files_mismatch;
-    int files_error;
-    int files_analized;
+    long files_ok;
+    long files_mismatch;
+    long files_error;
+    long files_analized;
 
 } Results;
 
 /* Created functions */
-void extensionValidation(char *file_to_validate, Results *file_results); /* Function: Checks file extension validation */
+void extensionValidation(char *file_to_validate, char *file_output, Results *file_results); /* Function: Checks file extension validation */
 char *returnFileExtension(char *filename, char c);                       /* Function: Returns the string of the extension */
-void split_path_file(char **p, char **f, char *pf);                      /* Function: To get file path and name */
\ No newline at end of file
+void split_path_file(char **p, char **f, char *pf);                      /* Function: To get file path and name */
+
+#endif /* EXTENSION_H */
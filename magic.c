@@ -0,0 +1,293 @@
+/* File library */
+#include "magic.h"
+
+/* Public libraries */
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Private libraries */
+#include "debug.h"
+#include "memory.h"
+
+/* Mime types as printed by "file -b --mime-type" (same order as the summary) */
+static const char *mime_types[MAGIC_NUM_TYPES] = {"application/pdf", "image/gif", "image/jpeg", "image/png", "video/mp4", "application/zip", "text/html"};
+static const char *type_names[MAGIC_NUM_TYPES + 1] = {"pdf", "gif", "jpg", "png", "mp4", "zip", "html", "other"};
+
+static int magicStartsWith(const unsigned char *header, size_t len, const char *magic, size_t magic_len); /* Function: Compares the first bytes of the header */
+static int magicIsText(const unsigned char *header, size_t len);                                      /* Function: Checks if the header only has text characters */
+static int magicIsPdf(const unsigned char *header, size_t len);                                       /* Function: Looks for "%PDF-" at the start (or near it in text files) */
+static int magicIsMp4(const unsigned char *header, size_t len);                                       /* Function: Checks the ftyp box and its major brand */
+static int magicIsZip(const unsigned char *header, size_t len);                                       /* Function: Checks the local file header of the first entry (-1: zip based document) */
+static size_t magicMatch(const unsigned char *text, size_t len, const char *pattern);                 /* Function: Case insensitive match, a ' ' in the pattern matches 1+ white spaces */
+static int magicIsHtml(const unsigned char *header, size_t len);                                      /* Function: Looks for an html tag in the header of a text file */
+static int magicTypeIndex(const char *mime_type);                                                     /* Function: Returns the position of a mime type in mime_types */
+
+const char *magicMimeType(const unsigned char *header, size_t len, const unsigned char *trailer, size_t trailer_len) /* Function: Returns the mime type of a file header/trailer (NULL if unknown) */
+{
+    int zip;
+
+    /* Same window as magicFileType() */
+    if (len > MAGIC_HEADER_SIZE)
+        len = MAGIC_HEADER_SIZE;
+
+    if (magicIsPdf(header, len))
+        return mime_types[0];
+    if (magicStartsWith(header, len, "GIF8", 4))
+        return mime_types[1];
+    /* file(1) needs one byte after the SOI marker */
+    if (len >= 4 && magicStartsWith(header, len, "\xff\xd8\xff", 3))
+        return mime_types[2];
+    /* Signature + IHDR chunk (length 13) */
+    if (magicStartsWith(header, len, "\x89PNG\r\n\x1a\n\x00\x00\x00\x0dIHDR", 16))
+        return mime_types[3];
+    if (magicIsMp4(header, len))
+        return mime_types[4];
+
+    /* Zip based documents (OpenDocument, EPUB, Office Open XML) have their own type in file(1) */
+    zip = magicIsZip(header, len);
+    if (zip < 0)
+        return NULL;
+
+    /* Local file header, end of central directory at the start (empty archive) or at the end (archive without comment) */
+    if (zip || magicStartsWith(header, len, "PK\x05\x06", 4) || (trailer_len == MAGIC_TRAILER_SIZE && magicStartsWith(trailer, trailer_len, "PK\x05\x06", 4)))
+        return mime_types[5];
+    if (magicIsHtml(header, len))
+        return mime_types[6];
+
+    return NULL;
+}
+
+int magicFileType(char *filename, const char **mime_type) /* Function: Reads the header/trailer of a file and detects its mime type */
+{
+    unsigned char *header = NULL;
+    unsigned char trailer[MAGIC_TRAILER_SIZE];
+    size_t len = 0;
+    size_t trailer_len = 0;
+    struct stat st;
+    ssize_t nread;
+
+    /* Only regular files: file(1) doesn't follow links (inode/symlink) and opening a FIFO would block */
+    if (lstat(filename, &st) < 0 || !S_ISREG(st.st_mode))
+        return -1;
+
+    int fd = open(filename, O_RDONLY | O_NOFOLLOW | O_NONBLOCK);
+    if (fd < 0)
+        return -1;
+
+    /* The file may have been replaced after lstat() */
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return -1;
+    }
+
+    /* Reads the same window file(1) checks for text */
+    header = MALLOC(MAGIC_HEADER_SIZE);
+    while (len < MAGIC_HEADER_SIZE && (nread = read(fd, header + len, MAGIC_HEADER_SIZE - len)) > 0)
+        len += (size_t)nread;
+
+    /* Reads the end of the file (only the end of central directory of zip files is checked there) */
+    if (st.st_size >= MAGIC_TRAILER_SIZE)
+    {
+        if (pread(fd, trailer, MAGIC_TRAILER_SIZE, st.st_size - MAGIC_TRAILER_SIZE) == MAGIC_TRAILER_SIZE)
+            trailer_len = MAGIC_TRAILER_SIZE;
+    }
+    close(fd);
+
+    *mime_type = magicMimeType(header, len, trailer, trailer_len);
+    FREE(header);
+    return 0;
+}
+
+void magicCompare(char *filename, char *file_output, Comparison *comparison) /* Function: Compares the detector with the file() output */
+{
+    const char *mime_type = NULL;
+    int index;
+
+    /* Files that can't be read are already reported as errors, other file types (links, FIFOs, ...) aren't compared */
+    if (magicFileType(filename, &mime_type) < 0)
+        return;
+
+    comparison->files_compared++;
+    index = magicTypeIndex(file_output);
+
+    /* Unsupported types only agree if the detector doesn't claim them */
+    if (mime_type == NULL ? index == MAGIC_NUM_TYPES : strcmp(mime_type, file_output) == 0)
+        return;
+
+    printf("[DIFF] '%s': file() type is '%s', checkFile type is '%s'\n", filename, file_output, mime_type ? mime_type : "unknown");
+    comparison->files_disagree++;
+    comparison->type_disagree[index]++;
+}
+
+void magicSummary(Comparison *comparison) /* Function: Prints the disagreements by type */
+{
+    printf("[COMPARE] files compared : %d; disagreements : %d;", comparison->files_compared, comparison->files_disagree);
+    for (int i = 0; i <= MAGIC_NUM_TYPES; ++i)
+        printf(" %s : %d;", type_names[i], comparison->type_disagree[i]);
+    printf("\n");
+}
+
+static int magicStartsWith(const unsigned char *header, size_t len, const char *magic, size_t magic_len) /* Function: Compares the first bytes of the header */
+{
+    return len >= magic_len && memcmp(header, magic, magic_len) == 0;
+}
+
+static int magicIsText(const unsigned char *header, size_t len) /* Function: Checks if the header only has text characters */
+{
+    /* Control characters that file(1) doesn't accept in text (tabs, new lines, form feeds and ESC are accepted) */
+    for (size_t i = 0; i < len; ++i)
+        if (header[i] <= 0x06 || (header[i] >= 0x0e && header[i] <= 0x1f && header[i] != 0x1b) || header[i] == 0x7f)
+            return 0;
+    return 1;
+}
+
+static int magicIsPdf(const unsigned char *header, size_t len) /* Function: Looks for "%PDF-" at the start (or near it in text files) */
+{
+    if (magicStartsWith(header, len, "%PDF-", 5))
+        return 1;
+
+    for (size_t i = 1; i <= MAGIC_PDF_SEARCH && i < len; ++i)
+        if (magicStartsWith(header + i, len - i, "%PDF-", 5))
+            return magicIsText(header, len);
+    return 0;
+}
+
+static int magicIsMp4(const unsigned char *header, size_t len) /* Function: Checks the ftyp box and its major brand */
+{
+    const char *brands[] = {"mp41", "mp42", "mmp4", "avc1", "dash", "isml", "F4V ", "F4P ", "M4P "};
+
+    /* ISO base media: box size (4 bytes) + "ftyp" + major brand */
+    if (len < 11 || memcmp(header + 4, "ftyp", 4) != 0)
+        return 0;
+
+    /* Any "iso" brand (isom, iso2, ...) */
+    if (memcmp(header + 8, "iso", 3) == 0)
+        return 1;
+    if (len < 12)
+        return 0;
+    for (size_t b = 0; b < sizeof(brands) / sizeof(brands[0]); ++b)
+        if (memcmp(header + 8, brands[b], 4) == 0)
+            return 1;
+    return 0;
+}
+
+static int magicIsZip(const unsigned char *header, size_t len) /* Function: Checks the local file header of the first entry (-1: zip based document) */
+{
+    /* Office Open XML parts that file(1) reports with their own type */
+    const char *office[] = {"word/", "xl/", "ppt/"};
+    size_t name_len;
+
+    if (len < 30 || !magicStartsWith(header, len, "PK\x03\x04", 4))
+        return 0;
+
+    /* Name of the first entry (offset 26: name length) */
+    name_len = (size_t)header[26] | (size_t)header[27] << 8;
+    if (len < 30 + name_len)
+        return 0;
+
+    /* OpenDocument/EPUB: the "mimetype" entry holds the type */
+    if (name_len == 8 && memcmp(header + 30, "mimetype", 8) == 0 && magicStartsWith(header + 38, len - 38, "application/", 12))
+        return -1;
+    for (size_t o = 0; o < sizeof(office) / sizeof(office[0]); ++o)
+        if (magicStartsWith(header + 30, name_len, office[o], strlen(office[o])))
+            return -1;
+
+    /* file(1) also reads 2 bytes after the name */
+    return len >= MAGIC_ZIP_MIN && len >= 30 + name_len + 2;
+}
+
+static size_t magicMatch(const unsigned char *text, size_t len, const char *pattern) /* Function: Case insensitive match, a ' ' in the pattern matches 1+ white spaces */
+{
+    size_t i = 0;
+
+    for (; *pattern != '\0'; ++pattern)
+    {
+        if (*pattern == ' ')
+        {
+            if (i >= len || !isspace(text[i]))
+                return 0;
+            while (i < len && isspace(text[i]))
+                i++;
+            continue;
+        }
+        if (i >= len || tolower(text[i]) != *pattern)
+            return 0;
+        i++;
+    }
+    return i;
+}
+
+static int magicIsHtml(const unsigned char *header, size_t len) /* Function: Looks for an html tag in the header of a text file */
+{
+    /* Tags of file(1), the element ones must be followed by a white space or '>' */
+    const char *tags[] = {"<!doctype html", "<a href="};
+    const char *elements[] = {"<html", "<head", "<title", "<script", "<style", "<table"};
+    size_t matched;
+
+    if (!magicIsText(header, len))
+        return 0;
+
+    /* XML and SVG documents come first in file(1), even with html tags */
+    if (magicMatch(header, len, "<?xml") || magicStartsWith(header, len, "<svg", 4) || magicMatch(header, len, "<!doctype svg"))
+        return 0;
+
+    for (size_t i = 0; i < len && i < MAGIC_SEARCH_SIZE; ++i)
+    {
+        if (header[i] != '<')
+            continue;
+
+        for (size_t t = 0; t < sizeof(tags) / sizeof(tags[0]); ++t)
+            if (magicMatch(header + i, len - i, tags[t]))
+                return 1;
+
+        for (size_t e = 0; e < sizeof(elements) / sizeof(elements[0]); ++e)
+        {
+            matched = magicMatch(header + i, len - i, elements[e]);
+            if (matched && i + matched < len && (header[i + matched] == '>' || isspace(header[i + matched])))
+                return 1;
+        }
+    }
+    return 0;
+}
+
+static int magicTypeIndex(const char *mime_type) /* Function: Returns the position of a mime type in mime_types */
+{
+    for (int i = 0; i < MAGIC_NUM_TYPES; ++i)
+        if (strcmp(mime_type, mime_types[i]) == 0)
+            return i;
+    return MAGIC_NUM_TYPES;
+}
+
+#ifdef CHECKFILE_FUZZ
+/* libFuzzer entry point over the header parsing (make fuzz), the input is a whole file */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    size_t trailer_len = size >= MAGIC_TRAILER_SIZE ? MAGIC_TRAILER_SIZE : 0;
+    const char *mime_type = magicMimeType(data, size, data + size - trailer_len, trailer_len);
+    const char *text_type = magicMimeType(data, size, NULL, 0);
+    unsigned char *binary;
+
+    /* The trailer is only used to find zip archives */
+    if (text_type != mime_type && mime_type != mime_types[5])
+        abort();
+
+    /* Text types (html, pdf after offset 0) stop being text with a binary byte anywhere in the text window */
+    if (size < MAGIC_HEADER_SIZE && (text_type == mime_types[6] || (text_type == mime_types[0] && !magicStartsWith(data, size, "%PDF-", 5))))
+    {
+        binary = MALLOC(size + 1);
+        memcpy(binary, data, size);
+        binary[size] = 0x00;
+        if (magicMimeType(binary, size + 1, NULL, 0) == text_type)
+            abort();
+        FREE(binary);
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,30 @@
+#ifndef MAGIC_H
+#define MAGIC_H
+
+/* Public libraries */
+#include <stddef.h>
+
+/* Defined variables */
+#define MAGIC_NUM_TYPES 7                       /* Types recognized by the in-process detector */
+#define MAGIC_SEARCH_SIZE 4096                  /* HTML tags must start in these bytes, as in file(1) */
+#define MAGIC_PDF_SEARCH 256                    /* Last offset of "%PDF-" in text files, as in file(1) */
+#define MAGIC_HEADER_SIZE 65536                 /* Bytes of the file header read by the detector, the text test window of file(1) */
+#define MAGIC_ZIP_MIN 50                        /* Smallest file with a local file header that file(1) calls a zip archive */
+#define MAGIC_TRAILER_SIZE 22                   /* Bytes of the file end read by the detector (zip end of central directory) */
+
+/* Structs */
+typedef struct /* Struct to save the differential results against file() */
+{
+    int files_compared;
+    int files_disagree;
+    int type_disagree[MAGIC_NUM_TYPES + 1]; /* Disagreements by file() type, last one for the unsupported types */
+
+} Comparison;
+
+/* Created functions */
+const char *magicMimeType(const unsigned char *header, size_t len, const unsigned char *trailer, size_t trailer_len); /* Function: Returns the mime type of a file header/trailer (NULL if unknown) */
+int magicFileType(char *filename, const char **mime_type);                                                           /* Function: Reads the header/trailer of a file and detects its mime type */
+void magicCompare(char *filename, char *file_output, Comparison *comparison);                                         /* Function: Compares the detector with the file() output */
+void magicSummary(Comparison *comparison);                                                                            /* Function: Prints the disagreements by type */
+
+#endif /* MAGIC_H */
@@ -24,10 +24,14 @@
 #include "debug.h"
 #include "memory.h"
 #include "extension.h"
+#include "sample.h"
+#include "magic.h"
 
 /* Created functions */
 void outputFile(void);
+char *readOutputFile(void);
 void deleteFile(char *filename);
+void analyzeFile(char *path, char *filename, Results *file_results, Comparison *comparison);
 void treatSignalInfo(int signal, siginfo_t *siginfo, void *context);
 
 /* Global Variables */
@@ -46,7 +50,9 @@ int main(int argc, char *argv[]) /* function: Main program execution */
     struct sigaction act_info;
 
     /* Variables */
-    int status;
+    Sample sample;
+    Comparison comparison = {0, 0, {0}}; /* initialized struct */
+    Comparison *compare = NULL;
 
     /* Signals */
     act_info.sa_sigaction = treatSignalInfo;
@@ -58,6 +64,13 @@ int main(int argc, char *argv[]) /* function: Main program execution */
     if (cmdline_parser(argc, argv, &args_info) != 0)
         ERROR(1, "cmdline_parser() failed!");
 
+    /* Reads the sampling mode (every file if --sample is not given) */
+    sampleParse(args_info.sample_arg, &sample);
+
+    /* Compares the in-process detector with file() */
+    if (args_info.compare_flag)
+        compare = &comparison;
+
     /* Verifications for signals */
     if (sigaction(SIGQUIT, &act_info, NULL) < 0)
         ERROR(1, "sigaction(SIGQUIT) failed!");
@@ -66,6 +79,10 @@ int main(int argc, char *argv[]) /* function: Main program execution */
     if (sigaction(SIGUSR1, &act_info, NULL) < 0)
         ERROR(1, "sigaction(SIGUSR1) failed!");
 
+    /* Scripted runs (--nowait) don't wait for the signals */
+    if (args_info.nowait_flag)
+        sig_SIGQUIT = sig_SIGINT = sig_SIGUSR1 = 0;
+
     /* Ignore SIGUSR1 signal if not batch/fich_with_filenames */
     if (!args_info.batch_arg)
         signal(SIGUSR1, SIG_IGN);
@@ -74,7 +91,8 @@ int main(int argc, char *argv[]) /* function: Main program execution */
     if (args_info.file_given)
     {
         /* Asks for signal and processeds with application */
-        printf("Please send a SIGQUIT to the process PID: %d\nUsage: kill -s SIGQUIT <PID>\n\n", getpid());
+        if (!args_info.nowait_flag)
+            printf("Please send a SIGQUIT to the process PID: %d\nUsage: kill -s SIGQUIT <PID>\n\n", getpid());
 
         /* Waits for the right signal */
         while (sig_SIGQUIT)
@@ -84,26 +102,20 @@ int main(int argc, char *argv[]) /* function: Main program execution */
 
         for (size_t i = 0; i < args_info.file_given; ++i)
         {
-            switch (fork()) /* -1: error; 0: son process; default: parent process */
-            {
-            case -1: /* Code only executed in case of error */
-                ERROR(1, "fork() failed!");
-                break;
-
-            case 0: /* Code only executed by the son process */
-                /* Creates output file */
-                outputFile();
-                /* The calling process image is replaced by the image of the executable called via “exec” */
-                execlp("file", "file", "-b", "--mime-type", args_info.file_arg[i], NULL);
-                break;
-
-            default: /* Code only executed by the parent process */
-                waitpid(-1, &status, 0);
-                /* Makes the file validations */
-                extensionValidation(args_info.file_arg[i], &files);
-                break;
-            }
+            /* Skips the files left out of the sample */
+            if (sampleKeep(&sample, args_info.file_arg[i]))
+                analyzeFile("", args_info.file_arg[i], &files, compare);
         }
+
+        /* Analyzes the files kept by the reservoir */
+        for (long i = 0; i < sample.files_kept; ++i)
+            analyzeFile("", sample.reservoir[i], &files, compare);
+
+        sampleSummary(&sample, &files);
+        sampleFree(&sample);
+        if (compare)
+            magicSummary(compare);
+
         /* Waits for the right signal */
         while (sig_SIGINT)
             pause();
@@ -114,7 +126,8 @@ int main(int argc, char *argv[]) /* function: Main program execution */
     {
 
         /* Asks for signal and processeds with application */
-        printf("Please send a SIGQUIT or SIGUSR1 to the process PID: %d\nUsage: kill -s SIGQUIT <PID>\n\n", getpid());
+        if (!args_info.nowait_flag)
+            printf("Please send a SIGQUIT or SIGUSR1 to the process PID: %d\nUsage: kill -s SIGQUIT <PID>\n\n", getpid());
 
         batch_filename = args_info.batch_arg;
 
@@ -146,32 +159,25 @@ int main(int argc, char *argv[]) /* function: Main program execution */
 
         while ((batch_file_nread = getline(&batch_file_line, &batch_file_len, fich_with_filenames)) != -1) /* Reads line from file */
         {
-            switch (fork())
-            {
-            case -1: /* Code only executed in case of error */
-                ERROR(1, "fork() failed!");
-                break;
-
-            case 0: /* Code only executed by the son process */
-                /* Adds each file to the user file path */
-                strcat(file, batch_file_line);
-                file[strcspn(file, "\n")] = 0;
-                /* Creates output file */
-                outputFile();
-                execlp("file", "file", "-b", "--mime-type", file, NULL);
-                break;
-
-            default: /* Code only executed by the parent process */
-                waitpid(-1, &status, 0);
-                extensionValidation(batch_file_line, &files);
-                break;
-            }
+            batch_file_line[strcspn(batch_file_line, "\n")] = 0;
+            /* Skips the files left out of the sample */
+            if (sampleKeep(&sample, batch_file_line))
+                analyzeFile(file, batch_file_line, &files, compare);
         }
 
-        printf("[SUMMARY] files analyzed : %d; files OK : %d; files MISMATCH : %d; errors: %d;\n", files.files_analized, files.files_ok, files.files_mismatch, files.files_error);
+        /* Analyzes the files kept by the reservoir */
+        for (long i = 0; i < sample.files_kept; ++i)
+            analyzeFile(file, sample.reservoir[i], &files, compare);
+
+        printf("[SUMMARY] files analyzed : %ld; files OK : %ld; files MISMATCH : %ld; errors: %ld;\n", files.files_analized, files.files_ok, files.files_mismatch, files.files_error);
+        sampleSummary(&sample, &files);
+        if (compare)
+            magicSummary(compare);
+        sampleFree(&sample);
 
         fclose(fich_with_filenames);
         free(batch_file_line);
+        free(file);
 
         /* Waits for the right signal */
         while (sig_SIGINT)
@@ -182,7 +188,8 @@ int main(int argc, char *argv[]) /* function: Main program execution */
     if (args_info.dir_arg)
     {
         /* Asks for signal and processeds with application */
-        printf("Please send a SIGQUIT to the process PID: %d\nUsage: kill -s SIGQUIT <PID>\n\n", getpid());
+        if (!args_info.nowait_flag)
+            printf("Please send a SIGQUIT to the process PID: %d\nUsage: kill -s SIGQUIT <PID>\n\n", getpid());
 
         /* Waits for the right signal */
         while (sig_SIGQUIT)
@@ -199,33 +206,32 @@ int main(int argc, char *argv[]) /* function: Main program execution */
 
         printf("[INFO] analyzing files of directory ‘%s’\n", args_info.dir_arg);
 
+        /* Adds "/" to know if file is directory */
+        char *dir_path = MALLOC(strlen(args_info.dir_arg) + 2);
+        sprintf(dir_path, "%s/", args_info.dir_arg);
+
         while ((dir = readdir(pDir)) != NULL)
         {
             if (strcmp(dir->d_name, ".") == 0 || strcmp(dir->d_name, "..") == 0)
                 continue;
 
-            switch (fork())
-            {
-            case -1: /* Code only executed in case of error */
-                ERROR(1, "fork() failed!");
-                break;
-
-            case 0: /* Code only executed by the son process */
-                /* Adds "/" to know if file is directory */
-                strcat(args_info.dir_arg, "/");
-                strcat(args_info.dir_arg, dir->d_name);
-                /* Creates output file */
-                outputFile();
-                execlp("file", "file", "-b", "--mime-type", args_info.dir_arg, NULL);
-                break;
-
-            default: /* Code only executed by the parent process */
-                waitpid(-1, &status, 0);
-                extensionValidation(dir->d_name, &files);
-                break;
-            }
+            /* Skips the files left out of the sample */
+            if (sampleKeep(&sample, dir->d_name))
+                analyzeFile(dir_path, dir->d_name, &files, compare);
         }
-        printf("[SUMMARY] files analyzed : %d; files OK : %d; files MISMATCH : %d; errors: %d;\n", files.files_analized, files.files_ok, files.files_mismatch, files.files_error);
+
+        /* Analyzes the files kept by the reservoir */
+        for (long i = 0; i < sample.files_kept; ++i)
+            analyzeFile(dir_path, sample.reservoir[i], &files, compare);
+
+        printf("[SUMMARY] files analyzed : %ld; files OK : %ld; files MISMATCH : %ld; errors: %ld;\n", files.files_analized, files.files_ok, files.files_mismatch, files.files_error);
+        sampleSummary(&sample, &files);
+        if (compare)
+            magicSummary(compare);
+        sampleFree(&sample);
+
+        closedir(pDir);
+        FREE(dir_path);
 
         /* Waits for the right signal */
         while (sig_SIGINT)
@@ -237,6 +243,10 @@ int main(int argc, char *argv[]) /* function: Main program execution */
 
     deleteFile("temp-output.txt");
 
+    /* Disagreements with file() are reported in the exit status */
+    if (compare && compare->files_disagree > 0)
+        return 2;
+
     return 0;
 }
 
@@ -257,6 +267,66 @@ void outputFile(void) /* Funtion: Creates the output file with user file extensi
         ERROR(1, "Closing - temp-output.txt");
 }
 
+char *readOutputFile(void) /* Function: Reads the file() output (one line) from the output file */
+{
+    /* Variables */
+    char *file_output = NULL;
+    size_t len = 0;
+
+    /* Opens output file + validates it */
+    FILE *f = fopen("temp-output.txt", "r");
+    if (f == NULL)
+        ERROR(1, "Could not open temp-output.txt for reading");
+
+    if (getline(&file_output, &len, f) == -1)
+        FREE(file_output);
+    else
+        file_output[strcspn(file_output, "\n")] = 0; /* Deletes '\n' from the output */
+
+    fclose(f);
+    return file_output;
+}
+
+void analyzeFile(char *path, char *filename, Results *file_results, Comparison *comparison) /* Function: Runs file() on path + filename and validates the extension */
+{
+    /* Variables */
+    int status;
+    char *file_output = NULL;
+    char *full_path = MALLOC(strlen(path) + strlen(filename) + 1);
+
+    sprintf(full_path, "%s%s", path, filename);
+
+    switch (fork()) /* -1: error; 0: son process; default: parent process */
+    {
+    case -1: /* Code only executed in case of error */
+        ERROR(1, "fork() failed!");
+        break;
+
+    case 0: /* Code only executed by the son process */
+        /* Creates output file */
+        outputFile();
+        /* The calling process image is replaced by the image of the executable called via “exec” */
+        execlp("file", "file", "-b", "--mime-type", full_path, NULL);
+        break;
+
+    default: /* Code only executed by the parent process */
+        waitpid(-1, &status, 0);
+        /* Reads the file() output once for both checks */
+        file_output = readOutputFile();
+        if (file_output == NULL)
+            break;
+        /* Checks the in-process detector against the file() output */
+        if (comparison)
+            magicCompare(full_path, file_output, comparison);
+        /* Makes the file validations */
+        extensionValidation(filename, file_output, file_results);
+        FREE(file_output);
+        break;
+    }
+
+    FREE(full_path);
+}
+
 void deleteFile(char *filename) /* Function: Deletes file */
 {
     switch (fork())
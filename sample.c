@@ -0,0 +1,170 @@
+/* File library */
+#include "sample.h"
+
+/* Public libraries */
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t sampleHash(char *filename);                      /* Function: FNV-1a hash of the file name */
+static char *sampleDup(char *filename);                          /* Function: Checked copy of a file name */
+static void sampleInterval(long k, long n, long population, double *low, double *high); /* Function: Wilson score interval with finite population correction */
+
+void sampleParse(char *sample_arg, Sample *sample) /* Function: Reads --sample as a fraction (0.05) or a count (1000) */
+{
+    char *end = NULL;
+
+    sample->mode = SAMPLE_NONE;
+    sample->fraction = 1.0;
+    sample->count = 0;
+    sample->files_seen = 0;
+    sample->files_kept = 0;
+    sample->reservoir_size = 0;
+    sample->reservoir = NULL;
+
+    if (sample_arg == NULL)
+        return;
+
+    /* A '.' means a fraction of the files, otherwise a number of files */
+    if (strchr(sample_arg, '.'))
+    {
+        sample->fraction = strtod(sample_arg, &end);
+        if (*end != '\0' || end == sample_arg || sample->fraction <= 0.0 || sample->fraction > 1.0)
+            ERROR(1, "Invalid --sample fraction '%s' (expected a value in ]0, 1])", sample_arg);
+        sample->mode = SAMPLE_FRACTION;
+        return;
+    }
+
+    errno = 0;
+    sample->count = strtol(sample_arg, &end, 10);
+    if (*end != '\0' || end == sample_arg || sample->count <= 0)
+        ERROR(1, "Invalid --sample count '%s' (expected a positive integer)", sample_arg);
+    if (errno == ERANGE || (unsigned long)sample->count > SIZE_MAX / sizeof(char *))
+        ERROR(1, "Invalid --sample count '%s' (too large)", sample_arg);
+    sample->mode = SAMPLE_COUNT;
+
+    /* Seeds the reservoir replacement (xorshift state can't be 0) */
+    sample->seed = ((uint64_t)time(NULL) << 16) ^ (uint64_t)getpid() ^ 0x9e3779b97f4a7c15ULL;
+}
+
+int sampleKeep(Sample *sample, char *filename) /* Function: Registers a walked file, returns 1 if it must be analyzed now */
+{
+    long slot;
+
+    sample->files_seen++;
+
+    switch (sample->mode)
+    {
+    case SAMPLE_FRACTION: /* Same name is always kept or always skipped, so audits are repeatable */
+        return (double)(sampleHash(filename) >> 11) * 0x1.0p-53 < sample->fraction;
+
+    case SAMPLE_COUNT: /* Algorithm R: the file is analyzed later, after the walk */
+        if (sample->files_kept < sample->count)
+        {
+            /* Grows the reservoir as it fills, never beyond count */
+            if (sample->files_kept == sample->reservoir_size)
+            {
+                sample->reservoir_size = sample->reservoir_size ? sample->reservoir_size * 2 : SAMPLE_RESERVOIR_MIN;
+                if (sample->reservoir_size > sample->count)
+                    sample->reservoir_size = sample->count;
+                sample->reservoir = realloc(sample->reservoir, sizeof(char *) * sample->reservoir_size);
+                if (sample->reservoir == NULL)
+                    ERROR(1, "Can't grow the sample reservoir to %ld files", sample->reservoir_size);
+            }
+            sample->reservoir[sample->files_kept++] = sampleDup(filename);
+            return 0;
+        }
+        sample->seed ^= sample->seed << 13;
+        sample->seed ^= sample->seed >> 7;
+        sample->seed ^= sample->seed << 17;
+        slot = (long)(sample->seed % (uint64_t)sample->files_seen);
+        if (slot < sample->count)
+        {
+            free(sample->reservoir[slot]);
+            sample->reservoir[slot] = sampleDup(filename);
+        }
+        return 0;
+
+    default: /* No sampling */
+        return 1;
+    }
+}
+
+void sampleFree(Sample *sample) /* Function: Frees the reservoir */
+{
+    for (long i = 0; i < sample->files_kept; ++i)
+        free(sample->reservoir[i]);
+    free(sample->reservoir);
+    sample->reservoir = NULL;
+    sample->reservoir_size = 0;
+    sample->files_kept = 0;
+}
+
+void sampleSummary(Sample *sample, Results *file_results) /* Function: Prints the estimated rates with confidence intervals */
+{
+    double low, high;
+    long n = file_results->files_analized;
+    long counts[3] = {file_results->files_ok, file_results->files_mismatch, file_results->files_error};
+    char *labels[3] = {"files OK", "files MISMATCH", "errors"};
+
+    if (sample->mode == SAMPLE_NONE)
+        return;
+
+    printf("[SAMPLE] files found : %ld; files sampled : %ld;\n", sample->files_seen, n);
+    if (n == 0)
+        return;
+
+    /* Every file was analyzed: the rates are exact */
+    if (n >= sample->files_seen)
+    {
+        printf("[ESTIMATE] all files analyzed;");
+        for (int i = 0; i < 3; ++i)
+            printf(" %s : %.2f%% (exact, %ld files);", labels[i], 100.0 * counts[i] / n, counts[i]);
+        printf("\n");
+        return;
+    }
+
+    printf("[ESTIMATE]");
+    for (int i = 0; i < 3; ++i)
+    {
+        sampleInterval(counts[i], n, sample->files_seen, &low, &high);
+        printf(" %s : %.2f%% (95%% CI %.2f%%-%.2f%%, ~%.0f files);", labels[i], 100.0 * counts[i] / n, 100.0 * low, 100.0 * high, (double)counts[i] / n * sample->files_seen);
+    }
+    printf("\n");
+}
+
+static uint64_t sampleHash(char *filename) /* Function: FNV-1a hash of the file name */
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (; *filename != '\0'; ++filename)
+    {
+        hash ^= (unsigned char)*filename;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static char *sampleDup(char *filename) /* Function: Checked copy of a file name */
+{
+    char *copy = MALLOC(strlen(filename) + 1);
+    strcpy(copy, filename);
+    return copy;
+}
+
+static void sampleInterval(long k, long n, long population, double *low, double *high) /* Function: Wilson score interval with finite population correction */
+{
+    double p = (double)k / n;
+    double z2 = SAMPLE_Z * SAMPLE_Z;
+    double center = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+    double margin = SAMPLE_Z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / (1.0 + z2 / n);
+    double correction = sqrt((double)(population - n) / (double)(population - 1));
+
+    *low = center - margin < 0.0 ? 0.0 : center - margin;
+    *high = center + margin > 1.0 ? 1.0 : center + margin;
+
+    /* Sampling without replacement (n < population): shrinks both sides of the interval towards p */
+    *low = p - (p - *low) * correction;
+    *high = p + (*high - p) * correction;
+}
@@ -0,0 +1,38 @@
+#ifndef SAMPLE_H
+#define SAMPLE_H
+
+/* Public libraries */
+#include <stdint.h>
+#include <stdio.h>
+
+/* Private libraries */
+#include "extension.h"
+
+/* Defined variables */
+#define SAMPLE_NONE 0     /* Every file is analyzed */
+#define SAMPLE_FRACTION 1 /* Hash-based sampling: keeps a fraction of the files */
+#define SAMPLE_COUNT 2    /* Reservoir sampling: keeps a fixed number of files */
+#define SAMPLE_Z 1.96     /* z value for the 95% confidence interval */
+#define SAMPLE_RESERVOIR_MIN 64 /* First allocation of the reservoir, doubled as it fills */
+
+/* Structs */
+typedef struct /* Struct to save the sampling state of a file/batch/directory walk */
+{
+    int mode;
+    double fraction;     /* SAMPLE_FRACTION: probability of a file being kept */
+    long count;          /* SAMPLE_COUNT: size of the reservoir */
+    long files_seen;     /* Files found during the walk (population) */
+    long files_kept;     /* Files currently in the reservoir */
+    long reservoir_size; /* SAMPLE_COUNT: allocated slots, grows up to count */
+    char **reservoir;    /* SAMPLE_COUNT: names of the kept files */
+    uint64_t seed;       /* SAMPLE_COUNT: xorshift64 state for the replacements */
+
+} Sample;
+
+/* Created functions */
+void sampleParse(char *sample_arg, Sample *sample);              /* Function: Reads --sample as a fraction (0.05) or a count (1000) */
+int sampleKeep(Sample *sample, char *filename);                   /* Function: Registers a walked file, returns 1 if it must be analyzed now */
+void sampleFree(Sample *sample);                                  /* Function: Frees the reservoir */
+void sampleSummary(Sample *sample, Results *file_results);        /* Function: Prints the estimated rates with confidence intervals */
+
+#endif /* SAMPLE_H */